@@ -0,0 +1,85 @@
+import matplotlib.pyplot as plt
+import numpy as np
+import argparse
+
+header_dtype = np.dtype([
+    ("magic", "S8"),
+    ("version", "<u4"),
+    ("nx_dims", "<u4"),
+    ("nv_dims", "<u4"),
+    ("reserved", "<u4"),
+    ("n", "<u8"),
+    ("step", "<u8"),
+    ("time", "<f8"),
+    ("q", "<f8"),
+    ("m", "<f8"),
+    ("weight", "<f8"),
+])
+
+
+def read_snapshot(path):
+    """Memory map a phase-space snapshot, returning its header and the (n, nx) and (n, nv)
+    position and velocity arrays."""
+    header = np.fromfile(path, dtype=header_dtype, count=1)[0]
+    if header["magic"] != b"CCPSNAP":
+        raise ValueError(f"{path} is not a phase-space snapshot")
+    if header["version"] != 1:
+        raise ValueError(f"{path} has unsupported snapshot version {header['version']}")
+
+    n = int(header["n"])
+    nx = int(header["nx_dims"])
+    nv = int(header["nv_dims"])
+
+    x = np.memmap(path, dtype="<f8", mode="r", offset=header_dtype.itemsize, shape=(n, nx))
+    v = np.memmap(path, dtype="<f8", mode="r", offset=header_dtype.itemsize + x.nbytes,
+                  shape=(n, nv))
+    return header, x, v
+
+
+def read_eedf(out):
+    """Read the time averaged electron energy distribution (one row per cell), compute the
+    corresponding EEPF and read the density of electrons above the histogram range."""
+    energy = np.genfromtxt(f"{out}/eedf_energy.txt")
+    eedf = np.atleast_2d(np.genfromtxt(f"{out}/eedf_e.txt"))
+    overflow = np.atleast_1d(np.genfromtxt(f"{out}/eedf_overflow_e.txt"))
+    return energy, eedf, eedf / np.sqrt(energy), overflow
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(
+        prog='read_snapshot',
+        description='Plot phase-space snapshots and electron energy distributions')
+
+    parser.add_argument("snapshot", nargs="?",
+                        help="Path to a binary phase-space snapshot.")
+
+    parser.add_argument("-o", "--out",
+                        help="Path to folder containing the EEDF data.")
+
+    args = parser.parse_args()
+
+    if args.snapshot is None and args.out is None:
+        parser.error("a snapshot file or --out folder is required")
+
+    if args.snapshot is not None:
+        header, x, v = read_snapshot(args.snapshot)
+        plt.figure()
+        plt.plot(x[:, 0], v[:, 0], ',')
+        plt.xlabel("x (m)")
+        plt.ylabel("vx (m/s)")
+        plt.title(f"step {header['step']}, t = {header['time']:.3e} s")
+
+    if args.out is not None:
+        energy, eedf, eepf, overflow = read_eedf(args.out)
+        d_energy = 2.0 * energy[0]
+        binned = eedf.sum() * d_energy
+        print(f"Electrons above {energy[-1] + 0.5 * d_energy:.1f} eV: "
+              f"{100.0 * overflow.sum() / (binned + overflow.sum()):.3f}%")
+        plt.figure()
+        plt.semilogy(energy, eepf[eepf.shape[0] // 2], label='center')
+        plt.semilogy(energy, eepf.mean(axis=0), label='average')
+        plt.xlabel("energy (eV)")
+        plt.ylabel("EEPF (m^-3 eV^-3/2)")
+        plt.legend()
+
+    plt.show()
@@ -1,5 +1,7 @@
 #include <argparse/argparse.hpp>
 #include <cstdio>
+#include <iostream>
+#include <stdexcept>
 #include <string>
 
 #include "spark/random/random.h"
@@ -47,12 +49,44 @@ int main(int argc, char* argv[]) {
         .default_value(data_path)
         .store_into(data_path);
 
-    args.parse_args(argc, argv);
+    args.add_argument("-s", "--snapshot-interval")
+        .help("Steps between binary phase-space snapshots, 0 disables them")
+        .default_value(size_t{0})
+        .action([](const std::string& value) {
+            // stoull skips leading whitespace and silently wraps negative values
+            const auto first = value.find_first_not_of(" \t");
+            if (first != std::string::npos && value[first] == '-') {
+                throw std::runtime_error("--snapshot-interval must not be negative");
+            }
+
+            size_t pos = 0;
+            unsigned long long interval = 0;
+            try {
+                interval = std::stoull(value, &pos);
+            } catch (const std::logic_error&) {
+                pos = 0;
+            }
+            if (pos == 0 || pos != value.size()) {
+                throw std::runtime_error("--snapshot-interval must be a whole number of steps");
+            }
+            return static_cast<size_t>(interval);
+        });
+
+    try {
+        args.parse_args(argc, argv);
+    } catch (const std::exception& err) {
+        fprintf(stderr, "%s\n", err.what());
+        std::cerr << args;
+        return 1;
+    }
 
     printf("Starting benchmark case %d simulation\n", case_number);
     printf("Data path set to %s\n", data_path.c_str());
 
-    ccp::Simulation sim(get_case_parameters(case_number), data_path);
+    auto parameters = get_case_parameters(case_number);
+    parameters.snapshot_interval = args.get<size_t>("--snapshot-interval");
+
+    ccp::Simulation sim(parameters, data_path);
     ccp::setup_events(sim);
     sim.run();
 
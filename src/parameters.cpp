@@ -11,6 +11,10 @@ void Parameters::fixed_parameters() {
     m_e = 9.109e-31;
     l = 6.7e-2;
     f = 13.56e6;
+    n_threads = 12;
+    snapshot_interval = 0;
+    eedf_n_bins = 200;
+    eedf_max_energy = 100.0;
 }
 
 void Parameters::computed_parameters() {
@@ -24,6 +24,10 @@ struct Parameters {
     size_t n_steps_avg;
     double particle_weight;
     size_t n_initial;
+    size_t n_threads;
+    size_t snapshot_interval;
+    size_t eedf_n_bins;
+    double eedf_max_energy;
 
     static Parameters case_1();
     static Parameters case_2();
@@ -37,7 +37,7 @@ void Simulation::run() {
     spark::core::TMatrix<spark::core::Vec<1>, 1> force_electrons_, force_ions_;
 
     auto poisson_solver = spark::em::ThomasPoissonSolver1D(parameters_.nx, parameters_.dx);
-    spark::threads::ThPool pool(12);
+    spark::threads::ThPool pool(parameters_.n_threads);
     events().notify(Event::Start, state_);
 
     for (step = 0; step < parameters_.n_steps; ++step) {
@@ -1,10 +1,18 @@
 
 #include "simulation_events.h"
 
+#include <spark/constants/constants.h>
+
 #include <chrono>
 #include <fstream>
 #include <ranges>
 #include <algorithm>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include "snapshot.h"
+#include "worker_group.h"
 
 namespace {
 template <class It>
@@ -21,6 +29,17 @@ void save_vec(const char* filename, const It& vec) {
     }
 }
 
+void save_matrix(const char* filename, const std::vector<double>& data, size_t n_cols) {
+    std::ofstream out_file(filename);
+
+    for (size_t i = 0; i < data.size(); ++i) {
+        if (i != 0) {
+            out_file << ((i % n_cols == 0) ? "\n" : " ");
+        }
+        out_file << data[i];
+    }
+}
+
 std::vector<double> count_to_density(double particle_weight,
                                      double dx,
                                      const std::vector<double>& count) {
@@ -108,13 +127,182 @@ void setup_events(Simulation& simulation) {
     auto avg_field_action = simulation.events().add_action(
         Simulation::Event::Step, AverageFieldAction(simulation.state().parameters()));
 
+    // Electron energy distribution per cell, accumulated over the same window as the densities.
+    // Each row holds n_bins energy bins plus a last column counting electrons above the range.
+    // The electrons are split across a worker group sized like the simulation thread pool. Every
+    // worker keeps its own histogram, and they are only merged when read.
+    struct ElectronEnergyHistogramAction : public Simulation::EventAction {
+        std::unique_ptr<WorkerGroup> workers;
+        std::vector<std::vector<double>> histograms;
+        size_t n_samples = 0;
+        size_t n_cells;
+        size_t n_bins;
+        double d_energy;
+        Parameters parameters_;
+
+        explicit ElectronEnergyHistogramAction(const Parameters& parameters)
+            : n_cells(parameters.nx - 1),
+              n_bins(parameters.eedf_n_bins),
+              d_energy(parameters.eedf_max_energy / static_cast<double>(parameters.eedf_n_bins)),
+              parameters_(parameters) {
+            workers = std::make_unique<WorkerGroup>(std::max<size_t>(parameters_.n_threads, 1));
+            histograms = std::vector<std::vector<double>>(
+                workers->size(), std::vector<double>(n_cells * (n_bins + 1), 0.0));
+        }
+
+        void notify(const Simulation::StateInterface& s) override {
+            if (s.step() > parameters_.n_steps - parameters_.n_steps_avg) {
+                const auto& electrons = s.electrons();
+                const auto& x = electrons.x();
+                const auto& v = electrons.v();
+                const double k = 0.5 * electrons.m() / spark::constants::e;
+                const size_t n = electrons.n();
+
+                const size_t chunk = (n + workers->size() - 1) / workers->size();
+
+                auto accumulate = [&](size_t worker) {
+                    auto& histogram = histograms[worker];
+                    const size_t end = std::min(n, (worker + 1) * chunk);
+                    for (size_t i = std::min(n, worker * chunk); i < end; ++i) {
+                        const double energy =
+                            k * (v[i].x * v[i].x + v[i].y * v[i].y + v[i].z * v[i].z);
+                        // Energies just below the limit can round up to n_bins, keep them binned
+                        const size_t bin =
+                            energy < parameters_.eedf_max_energy
+                                ? std::min(static_cast<size_t>(energy / d_energy), n_bins - 1)
+                                : n_bins;
+                        const auto cell =
+                            std::min(static_cast<size_t>(x[i].x / parameters_.dx), n_cells - 1);
+                        histogram[cell * (n_bins + 1) + bin] += 1.0;
+                    }
+                };
+
+                workers->run(accumulate);
+
+                n_samples++;
+            }
+        }
+
+        std::vector<double> merged_histogram() const {
+            auto h = histograms.front();
+            for (size_t worker = 1; worker < histograms.size(); ++worker) {
+                std::ranges::transform(h, histograms[worker], h.begin(), std::plus<>());
+            }
+            return h;
+        }
+
+        // Time averaged particle count per unit volume of each histogram entry
+        double density_scale() const {
+            return parameters_.particle_weight /
+                   (parameters_.dx * static_cast<double>(std::max<size_t>(n_samples, 1)));
+        }
+
+        // Time averaged electron energy distribution in m^-3 eV^-1, one row per cell
+        std::vector<double> eedf(const std::vector<double>& histogram) const {
+            const double scale = density_scale() / d_energy;
+            auto f = std::vector<double>(n_cells * n_bins);
+            for (size_t cell = 0; cell < n_cells; ++cell) {
+                for (size_t bin = 0; bin < n_bins; ++bin) {
+                    f[cell * n_bins + bin] = histogram[cell * (n_bins + 1) + bin] * scale;
+                }
+            }
+            return f;
+        }
+
+        // Time averaged density in m^-3 of electrons above eedf_max_energy, one value per cell
+        std::vector<double> overflow_density(const std::vector<double>& histogram) const {
+            const double scale = density_scale();
+            auto d = std::vector<double>(n_cells);
+            for (size_t cell = 0; cell < n_cells; ++cell) {
+                d[cell] = histogram[cell * (n_bins + 1) + n_bins] * scale;
+            }
+            return d;
+        }
+
+        std::vector<double> energy_bins() const {
+            auto e = std::vector<double>(n_bins);
+            for (size_t i = 0; i < e.size(); ++i) {
+                e[i] = (static_cast<double>(i) + 0.5) * d_energy;
+            }
+            return e;
+        }
+    };
+
+    auto energy_histogram_action = simulation.events().add_action(
+        Simulation::Event::Step,
+        ElectronEnergyHistogramAction(simulation.state().parameters()));
+
+    struct SnapshotAction : public Simulation::EventAction {
+        SnapshotWriter electrons_writer_;
+        SnapshotWriter ions_writer_;
+        bool enabled_ = true;
+        Parameters parameters_;
+
+        explicit SnapshotAction(const Parameters& parameters) : parameters_(parameters) {}
+
+        void notify(const Simulation::StateInterface& s) override {
+            if (enabled_ && s.step() % parameters_.snapshot_interval == 0) {
+                // Step actions run after the push, so the particles are already at step + 1
+                const double time = static_cast<double>(s.step() + 1) * parameters_.dt;
+                const auto suffix = std::to_string(s.step()) + ".bin";
+
+                // A failed snapshot must not abort the run and lose the averaged outputs
+                try {
+                    electrons_writer_.write("snapshot_e_" + suffix, s.electrons(), s.step(),
+                                            time, parameters_.particle_weight);
+                    ions_writer_.write("snapshot_i_" + suffix, s.ions(), s.step(), time,
+                                       parameters_.particle_weight);
+                } catch (const std::exception& e) {
+                    fprintf(stderr, "%s\nDisabling snapshots\n", e.what());
+                    enabled_ = false;
+                }
+            }
+        }
+
+        // Waits for the last snapshots so their errors are reported like the others
+        void finish() {
+            for (auto* writer : {&electrons_writer_, &ions_writer_}) {
+                try {
+                    writer->wait();
+                } catch (const std::exception& e) {
+                    fprintf(stderr, "%s\n", e.what());
+                }
+            }
+        }
+    };
+
+    struct FinishSnapshotsAction : public Simulation::EventAction {
+        std::weak_ptr<SnapshotAction> snapshot_action_;
+
+        explicit FinishSnapshotsAction(const std::weak_ptr<SnapshotAction>& snapshot_action)
+            : snapshot_action_(snapshot_action) {}
+
+        void notify(const Simulation::StateInterface&) override {
+            if (!snapshot_action_.expired()) {
+                snapshot_action_.lock()->finish();
+            }
+        }
+    };
+
+    if (simulation.state().parameters().snapshot_interval > 0) {
+        auto snapshot_action = simulation.events().add_action(
+            Simulation::Event::Step, SnapshotAction(simulation.state().parameters()));
+        simulation.events().add_action(Simulation::Event::End,
+                                       FinishSnapshotsAction(snapshot_action));
+    }
+
     struct SaveDataAction : public Simulation::EventAction {
         std::weak_ptr<AverageFieldAction> avg_field_action_;
+        std::weak_ptr<ElectronEnergyHistogramAction> energy_histogram_action_;
         Parameters parameters_;
 
-        explicit SaveDataAction(const std::weak_ptr<AverageFieldAction>& avg_field_action,
-                                const Parameters& parameters)
-            : avg_field_action_(avg_field_action), parameters_(parameters) {}
+        explicit SaveDataAction(
+            const std::weak_ptr<AverageFieldAction>& avg_field_action,
+            const std::weak_ptr<ElectronEnergyHistogramAction>& energy_histogram_action,
+            const Parameters& parameters)
+            : avg_field_action_(avg_field_action),
+              energy_histogram_action_(energy_histogram_action),
+              parameters_(parameters) {}
 
         void notify(const Simulation::StateInterface& s) override {
             if (!avg_field_action_.expired()) {
@@ -127,10 +315,20 @@ void setup_events(Simulation& simulation) {
                 save_vec("density_i.txt", count_to_density(parameters_.particle_weight,
                                                            parameters_.dx, avg_i.data()));
             }
+
+            if (!energy_histogram_action_.expired()) {
+                const auto energy_histogram_ptr = energy_histogram_action_.lock();
+                save_vec("eedf_energy.txt", energy_histogram_ptr->energy_bins());
+                const auto histogram = energy_histogram_ptr->merged_histogram();
+                save_matrix("eedf_e.txt", energy_histogram_ptr->eedf(histogram),
+                            parameters_.eedf_n_bins);
+                save_vec("eedf_overflow_e.txt", energy_histogram_ptr->overflow_density(histogram));
+            }
         }
     };
 
     simulation.events().add_action(
-        Simulation::Event::End, SaveDataAction(avg_field_action, simulation.state().parameters()));
+        Simulation::Event::End, SaveDataAction(avg_field_action, energy_histogram_action,
+                                               simulation.state().parameters()));
 }
 }  // namespace ccp
@@ -0,0 +1,72 @@
+#include "snapshot.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+void write_file(const std::string& filename, const char* data, size_t size) {
+    const int fd = open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("Unable to open snapshot file " + filename + ": " +
+                                 std::strerror(errno));
+    }
+
+    // Reserve the whole file up front so a full disk is reported before anything is written
+    if (const int err = posix_fallocate(fd, 0, static_cast<off_t>(size)); err != 0) {
+        close(fd);
+        throw std::runtime_error("Unable to allocate snapshot file " + filename + ": " +
+                                 std::strerror(err));
+    }
+
+    size_t written = 0;
+    while (written < size) {
+        const ssize_t res = ::write(fd, data + written, size - written);
+        if (res < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            const int err = errno;
+            close(fd);
+            throw std::runtime_error("Unable to write snapshot file " + filename + ": " +
+                                     std::strerror(err));
+        }
+        written += static_cast<size_t>(res);
+    }
+
+    if (close(fd) != 0) {
+        throw std::runtime_error("Unable to close snapshot file " + filename + ": " +
+                                 std::strerror(errno));
+    }
+}
+}  // namespace
+
+namespace ccp {
+
+SnapshotWriter::~SnapshotWriter() {
+    try {
+        wait();
+    } catch (const std::exception& e) {
+        fprintf(stderr, "%s\n", e.what());
+    }
+}
+
+void SnapshotWriter::wait() {
+    if (pending_write_.valid()) {
+        pending_write_.get();
+    }
+}
+
+void SnapshotWriter::write_raw(const std::string& filename) {
+    // The buffer is only touched again after wait(), so the worker can read it in place
+    pending_write_ = std::async(std::launch::async,
+                                [filename, data = buffer_.data(), size = buffer_.size()]() {
+                                    write_file(filename, data, size);
+                                });
+}
+
+}  // namespace ccp
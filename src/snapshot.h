@@ -0,0 +1,96 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <spark/particle/species.h>
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <future>
+#include <string>
+#include <vector>
+
+namespace ccp {
+
+// Binary phase-space snapshot layout: a fixed size header followed by the particle positions
+// (n * nx_dims doubles) and velocities (n * nv_dims doubles). Everything is little-endian.
+struct SnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t nx_dims;
+    uint32_t nv_dims;
+    uint32_t reserved;
+    uint64_t n;
+    uint64_t step;  // step during which the snapshot was taken
+    double time;    // physical time of the particle data, (step + 1) * dt after the push
+    double q;
+    double m;
+    double weight;
+};
+
+static_assert(sizeof(SnapshotHeader) % sizeof(double) == 0);
+static_assert(std::endian::native == std::endian::little,
+              "snapshots are written as raw little-endian arrays");
+
+// Writes the snapshots of one particle stream (e.g. the electrons of a run). The particle arrays
+// change on every step, so they are copied once into a buffer that is reused between snapshots,
+// and a background thread writes that buffer to disk. At most one write is in flight: when the
+// disk falls behind the snapshot rate, the next write() blocks the caller until it finishes.
+class SnapshotWriter {
+public:
+    SnapshotWriter() = default;
+    SnapshotWriter(SnapshotWriter&&) = default;
+    SnapshotWriter& operator=(SnapshotWriter&&) = delete;
+    ~SnapshotWriter();
+
+    // Errors from the previous write are rethrown here, before anything is copied.
+    template <unsigned NX, unsigned NV>
+    void write(const std::string& filename,
+               const spark::particle::ChargedSpecies<NX, NV>& species,
+               size_t step,
+               double time,
+               double weight) {
+        static_assert(sizeof(spark::core::Vec<NX>) == NX * sizeof(double));
+        static_assert(sizeof(spark::core::Vec<NV>) == NV * sizeof(double));
+
+        wait();
+
+        const size_t n = species.n();
+        const SnapshotHeader header{{'C', 'C', 'P', 'S', 'N', 'A', 'P', '\0'},
+                                    1,
+                                    NX,
+                                    NV,
+                                    0,
+                                    n,
+                                    step,
+                                    time,
+                                    species.q(),
+                                    species.m(),
+                                    weight};
+
+        const size_t x_size = n * sizeof(spark::core::Vec<NX>);
+        const size_t v_size = n * sizeof(spark::core::Vec<NV>);
+        buffer_.resize(sizeof(SnapshotHeader) + x_size + v_size);
+        std::memcpy(buffer_.data(), &header, sizeof(SnapshotHeader));
+        if (n > 0) {
+            std::memcpy(buffer_.data() + sizeof(SnapshotHeader), &species.x()[0], x_size);
+            std::memcpy(buffer_.data() + sizeof(SnapshotHeader) + x_size, &species.v()[0],
+                        v_size);
+        }
+
+        write_raw(filename);
+    }
+
+    // Blocks until the pending write has finished, rethrowing its error if it failed.
+    void wait();
+
+private:
+    std::vector<char> buffer_;
+    std::future<void> pending_write_;
+
+    void write_raw(const std::string& filename);
+};
+
+}  // namespace ccp
+
+#endif  // SNAPSHOT_H
@@ -0,0 +1,64 @@
+#include "worker_group.h"
+
+namespace ccp {
+
+WorkerGroup::WorkerGroup(size_t n_workers) {
+    for (size_t worker = 1; worker < n_workers; ++worker) {
+        threads_.emplace_back(&WorkerGroup::work, this, worker);
+    }
+}
+
+WorkerGroup::~WorkerGroup() {
+    {
+        std::lock_guard lock(mutex_);
+        stop_ = true;
+    }
+    start_.notify_all();
+
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+void WorkerGroup::run(const std::function<void(size_t)>& task) {
+    {
+        std::lock_guard lock(mutex_);
+        task_ = &task;
+        remaining_ = threads_.size();
+        generation_++;
+    }
+    start_.notify_all();
+
+    task(0);
+
+    std::unique_lock lock(mutex_);
+    done_.wait(lock, [this] { return remaining_ == 0; });
+    task_ = nullptr;
+}
+
+void WorkerGroup::work(size_t worker) {
+    size_t seen_generation = 0;
+
+    while (true) {
+        std::unique_lock lock(mutex_);
+        start_.wait(lock, [this, seen_generation] {
+            return stop_ || generation_ != seen_generation;
+        });
+        if (stop_) {
+            return;
+        }
+
+        seen_generation = generation_;
+        const auto* task = task_;
+        lock.unlock();
+
+        (*task)(worker);
+
+        lock.lock();
+        if (--remaining_ == 0) {
+            done_.notify_one();
+        }
+    }
+}
+
+}  // namespace ccp
@@ -0,0 +1,42 @@
+#ifndef WORKER_GROUP_H
+#define WORKER_GROUP_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ccp {
+
+// Fixed set of worker threads kept alive between calls to run(). The calling thread takes part
+// as worker 0, so a group of size n starts n - 1 threads.
+class WorkerGroup {
+public:
+    explicit WorkerGroup(size_t n_workers);
+    WorkerGroup(const WorkerGroup&) = delete;
+    WorkerGroup& operator=(const WorkerGroup&) = delete;
+    ~WorkerGroup();
+
+    size_t size() const { return threads_.size() + 1; }
+
+    // Calls task(worker) once for every worker index and returns when all of them have finished
+    void run(const std::function<void(size_t)>& task);
+
+private:
+    std::vector<std::thread> threads_;
+    std::mutex mutex_;
+    std::condition_variable start_;
+    std::condition_variable done_;
+    const std::function<void(size_t)>* task_ = nullptr;
+    size_t generation_ = 0;
+    size_t remaining_ = 0;
+    bool stop_ = false;
+
+    void work(size_t worker);
+};
+
+}  // namespace ccp
+
+#endif  // WORKER_GROUP_H